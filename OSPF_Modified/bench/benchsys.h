@@ -0,0 +1,76 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Support for the benchmarks, which run the core OSPF
+ * code with no network underneath. Packets sent are
+ * counted and discarded, and routing table updates are
+ * ignored. Time advances only when the benchmark says so.
+ */
+
+class BenchSys : public OspfSysCalls {
+  public:
+    void sendpkt(InPkt *pkt, int phyint, InAddr gw=0);
+    void sendpkt(InPkt *pkt);
+    bool phy_operational(int phyint);
+    void phy_open(int phyint);
+    void phy_close(int phyint);
+    void join(InAddr group, int phyint);
+    void leave(InAddr group, int phyint);
+    void ip_forward(bool enabled);
+    void set_multicast_routing(bool on);
+    void set_multicast_routing(int phyint, bool on);
+    void rtadd(InAddr, InMask, MPath *, MPath *, bool);
+    void rtdel(InAddr, InMask, MPath *ompp);
+    void add_mcache(InAddr, InAddr, MCache *);
+    void del_mcache(InAddr src, InAddr group);
+    void upload_remnants();
+    void monitor_response(struct MonMsg *, uns16, int, int);
+    char *phyname(int phyint);
+    void sys_spflog(int msgno, char *msgbuf);
+    void store_hitless_parms(int, int, struct MD5Seq *);
+    void halt(int code, char *string);
+};
+
+/* A received OSPF Hello, with room for a list of
+ * neighbors. Built once, and then handed to OSPF::rxpkt()
+ * as often as required.
+ */
+
+class BenchHello {
+    enum {
+	MaxNbrs = 16,
+    };
+    byte buffer[sizeof(InPkt) + sizeof(HloPkt) + MaxNbrs*sizeof(rtid_t)];
+  public:
+    int plen;
+    InPkt *iphdr;
+    HloPkt *hlopkt;
+    BenchHello(InAddr src, rtid_t id, aid_t area, InMask mask,
+	       rtid_t *nbrs=0, int n_nbrs=0);
+};
+
+// Setup of the OSPF instance being measured
+void bench_start(rtid_t id);
+void bench_area(aid_t id);
+void bench_ifc(InAddr addr, InMask mask, int phyint, aid_t area, int type);
+void bench_done();
+
+// Time, both simulated and real
+void bench_advance(uns32 msec);
+double bench_usec();
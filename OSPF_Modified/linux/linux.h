@@ -28,12 +28,15 @@ class Linux : public OspfSysCalls {
     uns16 ospfd_mon_port;
     int listenfd; // Listen for monitoring connection
     AVLtree monfds; // Current monitoring connections
+  protected:
+    int epfd;	// epoll descriptor for all sockets
   public:
     void monitor_response(struct MonMsg *, uns16, int, int);
 
     Linux(uns16 mon_port);
-    void mon_fd_set(int &, fd_set *, fd_set *);
-    void process_mon_io(fd_set *, fd_set *);
+    void ep_add(int fd);
+    void mon_epoll_update();
+    bool process_mon_event(int fd, uns32 events);
     void process_monitor_request(class TcpConn *);
     void accept_monitor_connection();
     void close_monitor_connection(class TcpConn *);
@@ -43,6 +46,7 @@ class Linux : public OspfSysCalls {
 
 class TcpConn : public AVLitem {
     TcpPkt monpkt; // Packet processing for monitor connection
+    bool wr_armed; // Waiting for socket to become writable?
   public:
     inline int monfd();	// Monitoring connection
     TcpConn(int fd);
@@ -51,6 +51,9 @@ set global_att(host) 0
 set global_att(refresh_rate) 0
 set global_att(PPAdjLimit) 0
 set global_att(random_refresh) 0
+set global_att(ovl_init_delay) 50
+set global_att(ovl_hold) 200
+set global_att(ovl_max_hold) 5000
 
 set IGMP_OFF 0
 set IGMP_ON 1
@@ -72,6 +75,7 @@ set IGMP_DFLT 2
 #	refresh_rate %seconds
 #	PPAdjLimit %no
 #	random_refresh
+#	overlay_throttle %init_ms %hold_ms %max_hold_ms
 ###############################################################
 
 proc ospfExtLsdbLimit {val} {
@@ -122,6 +126,12 @@ proc random_refresh {} {
     global global_att
     set global_att(random_refresh) 1
 }
+proc overlay_throttle {init hold max_hold} {
+    global global_att
+    set global_att(ovl_init_delay) $init
+    set global_att(ovl_hold) $hold
+    set global_att(ovl_max_hold) $max_hold
+}
 
 ###############################################################
 # Area configuration:
@@ -455,7 +465,9 @@ proc sendcfg {} {
 	    $global_att(new_flood_rate) $global_att(max_rxmt_window) \
 	    $global_att(max_dds) $global_att(base_level) \
 	    $global_att(host) $global_att(refresh_rate) \
-	    $global_att(PPAdjLimit) $global_att(random_refresh)
+	    $global_att(PPAdjLimit) $global_att(random_refresh) \
+	    $global_att(ovl_init_delay) $global_att(ovl_hold) \
+	    $global_att(ovl_max_hold)
     foreach a $areas {
 	sendarea $a $area_att($a,stub) $area_att($a,dflt_cost) \
 		$area_att($a,import_summs)
@@ -22,11 +22,33 @@
 class LinuxOspfd : public Linux {
     enum { 
         MAXIFs=255, // Maximum number of interfaces
+        NL_BUFSIZE=32768, // Batched rtnetlink route messages
+        NL_MAXRTMSG=512, // Largest single route message
+        NL_WINDOW=512, // Route messages awaiting ack, at most
+        NL_MAXRECV=256, // rtnetlink reads before servicing timers
+        RCV_BATCH=32, // Packets read by each recvmmsg()
+        RCV_MAXBATCHES=8, // recvmmsg() calls before servicing timers
+        RCV_CMSGLEN=128, // Ancillary data per received packet
+        MAXEVENTS=16, // Socket events per epoll_wait()
+        XMT_BATCH=64, // Packets sent by each sendmmsg()
+        XMT_BUFSIZE=262144, // Bytes of queued packets
     };
     int netfd;	// File descriptor used to send and receive
     int igmpfd; // File descriptor for multicast routing
     int udpfd;	// UDP file descriptor for ioctl's
     int rtsock; // rtnetlink file descriptor
+    int rtupd;	// rtnetlink socket for route updates and acks
+    struct mmsghdr *rcv_msgs; // Batch receive headers
+    iovec *rcv_iov; // One packet buffer per header
+    char *rcv_buff; // Batch receive packet buffers
+    byte *rcv_cmsg; // Batch receive ancillary data
+    struct mmsghdr *xmt_msgs; // Queued transmit headers
+    iovec *xmt_iov; // Queued packet locations
+    sockaddr_in *xmt_to; // Queued packet destinations
+    byte *xmt_cmsg; // Queued packet outgoing interfaces
+    char *xmt_buff; // Copies of queued packets
+    int n_xmt;	// # packets queued
+    int xmt_len; // Bytes used in xmt_buff
     timeval last_time; // Last return from gettimeofday
     int next_phyint; // Next phyint value
     AVLtree phyints; // Physical interfaces
@@ -34,6 +56,12 @@ class LinuxOspfd : public Linux {
     AVLtree directs; // Directly attached prefixes
     rtentry m;
     uns32 nlm_seq;
+    AVLtree rtqueue; // Kernel route updates not yet sent
+    char *nl_buff; // Route messages being batched
+    int nl_len;	// Bytes used in nl_buff
+    int nl_msgs; // Messages in nl_buff
+    uns32 nl_pending; // Route messages awaiting kernel ack
+    uns32 nl_errors; // Route messages rejected by kernel
     FILE *logstr;
     bool changing_routerid;
     bool change_complete;
@@ -68,11 +96,20 @@ class LinuxOspfd : public Linux {
     void read_kernel_interfaces();
     void one_second_timer();
     void rtentry_prepare(InAddr, InMask, MPath *mpp);
+    void rt_queue(InAddr, InMask, MPath *, bool reject, bool del);
+    void rt_flush(bool all=false);
+    void nl_route(class KrtUpdate *);
+    bool nl_send();
+    void xmt_queue(InPkt *pkt, int phyint);
+    void xmt_flush();
     void add_direct(class BSDPhyInt *, InAddr, InMask);
     int get_phyint(InAddr);
     bool parse_interface(const char *, in_addr &, BSDPhyInt * &);
     void raw_receive(int fd);
+    void raw_dispatch(int phyint, InPkt *pkt, int plen);
     void netlink_receive(int fd);
+    void netlink_dispatch(int plen);
+    void netlink_overrun(int fd);
     void process_routerid_change();
     void set_flags(class BSDPhyInt *, short flags);
     friend int main(int argc, char *argv[]);
@@ -152,5 +189,19 @@ class DirectRoute : public AVLitem {
     DirectRoute(InAddr addr, InMask mask) : AVLitem(addr, mask) {}
 };
 
+/* A kernel routing table update that has yet to be sent
+ * over the rtnetlink socket. Indexed by prefix, so that
+ * repeated changes to the same prefix during a routing
+ * calculation result in a single message to the kernel.
+ */
+
+class KrtUpdate : public AVLitem {
+  public:
+    MPath *mpp;
+    bool reject;
+    bool del;
+    KrtUpdate(InAddr net, InMask mask) : AVLitem(net, mask) {}
+};
+
 // Maximum size of an IP packet
 const int MAX_IP_PKTSIZE = 65535;
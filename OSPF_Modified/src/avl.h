@@ -123,6 +123,7 @@ class AVLtree {
     AVLitem *_root; 	// Root element
     uns32 count; 	// # elements on tree
     uns32 instance;	// Changes on add and deletes
+    uns32 removals;	// Changes on deletes only
 public:
     AVLitem *sllhead;	// Order list head
 
@@ -138,7 +139,8 @@ public:
 friend class AVLsearch;
 };
 
-inline AVLtree::AVLtree() : _root(0), count(0), instance(0), sllhead(0)
+inline AVLtree::AVLtree()
+: _root(0), count(0), instance(0), removals(0), sllhead(0)
 {
 }
 inline AVLitem *AVLtree::root()
@@ -154,11 +156,15 @@ inline int AVLtree::size()
  * Note that we could have cached a place in the tree (via a stack)
  * instead of just keeping indexes; that would have been more efficient,
  * but would force the iterator to lock out tree updates.
+ * The current item is cached, and followed along the ordered
+ * list, for as long as nothing has been removed from the tree.
+ * Only removals force the iterator to search for its place again.
  */
 
 class AVLsearch {
     AVLtree *tree;	 // Tree to search
     uns32 instance;	// Corresponding tree instance
+    uns32 removals;	// Corresponding tree removals
     uns32 c_index1;	// current place
     uns32 c_index2;
     AVLitem *current;
@@ -174,6 +180,7 @@ inline AVLsearch::AVLsearch(AVLtree *avltree)
 
 {    
     instance = tree->instance;
+    removals = tree->removals;
 }
 void AVLsearch::seek(AVLitem *item)
 {
@@ -56,6 +56,9 @@ struct CfgGen {
     int32 refresh_rate;	// Rate to refresh DoNotAge LSAs
     uns32 PPAdjLimit;	// Max # p-p adjacencies to neighbor
     int random_refresh;	// Should we spread out LSA refreshes?
+    uns32 ovl_init_delay;// Overlay calculation delay after quiet (ms)
+    uns32 ovl_hold;	// Initial overlay calculation hold time (ms)
+    uns32 ovl_max_hold;	// Maximum overlay calculation hold time (ms)
 
     void set_defaults();
 };
@@ -49,6 +49,9 @@ protected:
     LSA	*lsa_agerv;	// reverse link in age bins
     uns16 lsa_agebin;	// Age bin
     uns16 lsa_rxmt;	// #Retransmission lists
+    class LsaListElement *lsa_elts; // Retransmission list elements
+    byte *lsa_image;	// Network-order copy, for flooding
+    uns16 image_size;	// Size of lsa_image buffer
     uns16 in_agebin:1,	// In an age bin?
 	deferring:1,	// Awaiting deferred origination
 	changed:1,	// Changed since last flood
@@ -59,7 +62,8 @@ protected:
         sent_reply:1,	// Sent reply for older LSA received
         checkage:1,	// Queued for xsum verification
         min_failed:1,	// MinArrival failed
-        we_orig:1;	// We have originated this LSA
+        we_orig:1,	// We have originated this LSA
+        image_ok:1;	// lsa_image matches this instance
     uns16 lsa_hour;	// Hour counter, for DoNotAge refresh
 
     static LSA *AgeBins[MaxAge+1];// Aging Bins
@@ -79,6 +83,10 @@ public:
 
     LSA(class SpfIfc *, class SpfArea *, LShdr *, int blen = 0);
     virtual ~LSA();
+    static SlabAlloc slab;	// LSA objects, all types
+    static SlabAlloc body_slab; // Unparsed LSA bodies
+    inline void *operator new(size_t size);
+    inline void operator delete(void *ptr, size_t size);
 
     inline byte ls_type();
     inline lsid_t ls_id();
@@ -106,6 +114,8 @@ public:
     friend class SpfNbr;
     friend class SpfIfc;
     friend class SpfArea;
+    friend class LsaList;
+    friend class LsaListElement;
     friend class LsaListIterator;
     friend class LocalOrigTimer;
     friend class DBageTimer;
@@ -117,6 +127,14 @@ public:
 };
 
 // Inline functions
+inline void *LSA::operator new(size_t size)
+{
+    return(slab.alloc(size));
+}
+inline void LSA::operator delete(void *ptr, size_t size)
+{
+    slab.release(ptr, size);
+}
 inline byte LSA::ls_type()
 {
     return(lsa_type);
@@ -174,11 +192,11 @@ protected:
     byte dijk_run:1,	// Dijkstra run, sequence number
 	t_direct:1,	// Directly attached to root?
 	t_downstream:1,	// Downstream from MOSPF root
-	in_mospf_cache:1;// Linked into MOSPF entry under construction
+	in_mospf_cache:1;// Recorded in MOSPF path under construction
     byte t_state;	// Uninit, on cand or SPF
     byte il_type;	// Incoming link type (MOSPF)
     byte t_ttl;		// TTL from us to node, on MOSPF branch
-    byte closest_member;// TTL to closest group member, through this next hop
+    int t_dsindex;	// Index in MOSPF path's downstream neighbors
     TNode *t_parent;	// Parent on SPF tree
     TNode *t_mospf_dsnode; // Node directly downstream on this branch
     MPath *t_mpath;	// Multipath entry
@@ -199,6 +217,7 @@ public:
     friend class RTE;
     friend class VLIfc;
     friend class SpfArea;
+    friend class MospfPath;
 };
 
 // Encoding of t_state
@@ -360,6 +379,10 @@ public:
 class ASextLSA : public rteLSA {
     FWDrte *fwd_addr;	// Forwarding address routing entry
     uns32 adv_tag;	// Advertised tag
+    ASextLSA *src_next;	// LSAs from the same ASBR
+    ASextLSA *src_prev;
+    ASextLSA *fa_next;	// LSAs with the same forwarding address
+    ASextLSA *fa_prev;
 public:
     ASextLSA(LShdr *, int blen);
     virtual void reoriginate(int forced);
@@ -369,6 +392,8 @@ public:
     friend class OSPF;
     friend class INrte;
     friend class SpfArea;
+    friend class ASBRrte;
+    friend class FWDrte;
 };
 
 /* Body of group-membership-LSA points to one or more
@@ -27,17 +27,29 @@
 
 /*
  * Dynamically constructed lists are made
- * out of the following two word structure: the first field for the
- * singly-linked list, and the second for a pointer to the LSA (car/cdrs).
+ * out of the following structure: the first two fields for the
+ * doubly-linked list, and the third for a pointer to the LSA (car/cdrs).
  *
  * Whenever an LSA is on a list, its reference count
  * is incremented. LSAs are not actually freed until their reference
  * count goes to 0.
+ *
+ * An indexed list also keeps a hash table of its elements,
+ * keyed by LSA, so that an LSA can be found on (and removed
+ * from) the list without searching it. Its elements are also
+ * chained, in both directions, off the LSA itself. Used for
+ * the neighbor retransmission lists, which can grow very long,
+ * and of which a single LSA may be on very many.
  */
 
 class LsaListElement {
     LsaListElement *next; 	// Next in list
+    LsaListElement *prev; 	// Previous in list
     LSA	*lsap;			// Pointer to LSA
+    class LsaList *list;	// Indexed list containing element
+    LsaListElement *lsa_next;	// Next indexed element for the LSA
+    LsaListElement *lsa_prev;	// Previous indexed element for the LSA
+    LsaListElement *hnext;	// Indexed list's hash chain
     // For customized memory mgmt
     enum {
 	BlkSize = 256
@@ -59,12 +71,22 @@ public:
     inline int n_alloc_elements();
 };
 
-inline LsaListElement::LsaListElement(LSA *adv) : next(0), lsap(adv)
+inline LsaListElement::LsaListElement(LSA *adv)
+: next(0), prev(0), lsap(adv), list(0), lsa_next(0), lsa_prev(0),
+  hnext(0)
 {
     adv->ref();
 }
 inline LsaListElement::~LsaListElement()
 {
+    if (list) {
+	if (lsa_prev)
+	    lsa_prev->lsa_next = lsa_next;
+	else
+	    lsap->lsa_elts = lsa_next;
+	if (lsa_next)
+	    lsa_next->lsa_prev = lsa_prev;
+    }
     lsap->deref();
 }
 inline int LsaListElement::n_free_elements()
@@ -77,16 +99,32 @@ inline int LsaListElement::n_alloc_elements()
 }
 
 /* The list header, which consists of a head pointer, tail pointer
- * and a count of the current list size.
+ * and a count of the current list size. Indexed lists add
+ * a hash table, allocated when the first element is added,
+ * which doubles whenever the list outgrows it.
  */
 
 class LsaList {
+    enum {
+	MinHashBits = 4, // Smallest hash table, 16 buckets
+    };
     LsaListElement *head; 	// Head of list
     LsaListElement *tail; 	// tail of list
     int	size;			// # elements on list
+    bool indexed;		// Elements hashed by LSA?
+    LsaListElement **htbl;	// Hash table, if indexed
+    int	hbits;			// log2(# hash buckets)
+
+    inline void unlink(LsaListElement *);
+    inline int hash(LSA *);
+    LsaListElement *find(LSA *);
+    void hash_fit(int n);
+    void hash_add(LsaListElement *);
+    void hash_delete(LsaListElement *);
 
 public:
-    inline LsaList();
+    inline LsaList(bool _indexed=false);
+    inline ~LsaList();
     inline void addEntry(LSA *);
     inline LSA *FirstEntry();
     int	remove(LSA *);
@@ -99,9 +137,14 @@ public:
     friend class LsaListIterator;
 };
 
-inline LsaList::LsaList() : head(0), tail(0), size(0)
+inline LsaList::LsaList(bool _indexed)
+: head(0), tail(0), size(0), indexed(_indexed), htbl(0), hbits(0)
 {
 }
+inline LsaList::~LsaList()
+{
+    delete [] htbl;
+}
 inline LSA *LsaList::FirstEntry()
 {
     return(head ? head->lsap : 0);
@@ -123,17 +166,58 @@ inline void LsaList::addEntry(LSA *lsap)
     LsaListElement *ep;
 
     ep = new LsaListElement(lsap);
+    if (indexed) {
+	hash_fit(size + 1);
+	hash_add(ep);
+	ep->list = this;
+	if ((ep->lsa_next = lsap->lsa_elts))
+	    ep->lsa_next->lsa_prev = ep;
+	lsap->lsa_elts = ep;
+    }
     if (!head) {
 	head = ep;
 	tail = ep;
     }
     else {
+	ep->prev = tail;
 	tail->next = ep;
 	tail = ep;
     }
     size++;
 }
 
+// LsaList::unlink(). Take element off the list, without freeing it.
+
+inline void LsaList::unlink(LsaListElement *ep)
+
+{
+    if (!ep->prev)
+	head = ep->next;
+    else
+	ep->prev->next = ep->next;
+    if (!ep->next)
+	tail = ep->prev;
+    else
+	ep->next->prev = ep->prev;
+    size--;
+    if (indexed)
+	hash_delete(ep);
+}
+
+/* LsaList::hash(). Hash bucket of an LSA, taken from the
+ * high-order bits of the product of its address and
+ * the golden ratio.
+ */
+
+inline int LsaList::hash(LSA *lsap)
+
+{
+    uns32 key;
+
+    key = (uns32) (((size_t) lsap) >> 3);
+    return((key * 0x9e3779b1U) >> (32 - hbits));
+}
+
 /* The iterator class, used when walking down an LsaList.
  * Primitives provided to walk down the list, and to delete the
  * "current" list element (which may or may not be the list's
@@ -180,13 +264,7 @@ inline void LsaListIterator::remove_current()
 
 {
     if (current) {
-	if (list->tail == current)
-	    list->tail = prev;
-	list->size--;
-	if (!prev)
-	    list->head = current->next;
-	else
-	    prev->next = current->next;
+	list->unlink(current);
 	delete current;
 	current = prev;
     }
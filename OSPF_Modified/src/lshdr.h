@@ -186,6 +186,7 @@ enum {
     OPQ_T_MULTI_ABR = 5,    //ABR-LSA
     OPQ_T_MULTI_PREFIX = 6,    //Prefix-LSA
     OPQ_T_MULTI_ASBR = 7,    //ASBR-LSA
+    OPQ_T_MULTI_PREFIXES = 8,    //Packed Prefix-LSA (TLVs)
 };
 
 struct ABRhdr { //body of ABR-LSA, per neighbor
@@ -204,6 +205,12 @@ struct ASBRhdr { //body of ASBR-LSA
     uns32 dest_rid;     //ASBR RID
 };
 
+struct PrefixTLV { //value of a Packed Prefix-LSA prefix TLV
+    uns32 metric;       //intra-area cost to prefix
+    uns32 subnet_mask;  //prefix mask
+    uns32 subnet_addr;  //prefix address
+};
+
 /* Format of the TLVs found in the body of some Opaque-LSAs.
  * Length field covers only the body, not the header, and
  * when the length is not a multiple of 4 bytes, the TLV
@@ -233,3 +240,10 @@ enum {
    HLRST_REASON_RELOAD = 2,	// Reload/upgrade
    HLRST_REASON_SWITCH = 3,	// Switch to redundant processor
 };
+
+/* TLV types used in the Packed Prefix-LSAs
+ */
+
+enum {
+    PFX_TLV_PREFIX = 1,	// One advertised prefix (PrefixTLV)
+};
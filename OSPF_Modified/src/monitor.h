@@ -83,6 +83,8 @@ struct StatRsp {
     uns32 extdb_limit;
     uns32 n_dijkstra;
     uns32 n_overlay_dijkstra;
+    uns32 n_overlay_incremental;
+    uns32 n_overlay_nh;
     uns16 n_area;
     uns16 n_dbx_nbrs;
     byte mospf;
@@ -93,6 +95,25 @@ struct StatRsp {
     byte vminor;
     uns16 fill1;
     uns32 n_orig_allocs;
+    uns32 n_xmt_pkts;
+    uns32 n_xmt_calls;
+    uns32 n_lsa_objs;	// Slab allocator usage
+    uns32 lsa_obj_bytes;
+    uns32 n_lsa_bodies;
+    uns32 lsa_body_bytes;
+    uns32 n_inrtes;
+    uns32 inrte_bytes;
+    uns32 n_ovl_prefixes;
+    uns32 n_ovl_asbrs;
+    uns32 slab_reserved;
+    uns32 n_ovl_pfx_pending;	// Overlay origination queue
+    uns32 n_ovl_asbr_pending;
+    uns32 n_ovl_deferred;
+    uns32 n_ase_full;	// External route calculations
+    uns32 n_ase_partial;
+    uns32 n_ase_touched;
+    uns32 n_lpm_nodes;	// Best match index
+    uns32 lpm_bytes;
 };
 
 /* Response to a request for area statistics.
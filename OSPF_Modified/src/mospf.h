@@ -41,3 +41,62 @@ class MospfEntry : public AVLitem {
     MospfEntry(InAddr src, InAddr group);
     friend class OSPF;
 };
+
+/* A node on one of the downstream branches of a MOSPF
+ * path, recorded so that the branch can be pruned
+ * for each group without rerunning the Dijkstra.
+ * Only the node's identity is kept, not the LSA itself,
+ * so that saved paths do not hold LSAs in the database.
+ */
+
+struct MospfBranch {
+    byte ls_type;	// Node's LS type
+    bool wild;		// Wild-card multicast receiver?
+    lsid_t ls_id;	// Node's Link State ID
+    rtid_t adv_rtr;	// Node's Advertising Router
+    byte ttl;		// TTL from us to the node
+    int ds;		// Index of the branch's downstream neighbor
+};
+
+/* The result of the MOSPF path calculation through a single
+ * area. This does not depend on the group: only the
+ * closest member along each downstream branch does, and
+ * that is computed from the recorded branches when a
+ * cache entry is built.
+ */
+
+class MospfPath {
+    MospfPath *next;	// Path through next area
+    SpfArea *ap;	// Area
+    int mcase;		// Source case
+    uns32 cost;		// Cost from source
+    int n_upstream;	// Incoming interfaces
+    int *up_phys;
+    int n_ds;		// Downstream neighbors, ttl not set
+    DownStr *ds;
+    TNode **ds_node;	// Downstream nodes, during calculation only
+    int n_branch;	// Branch nodes, in Dijkstra order
+    int sz_branch;
+    MospfBranch *branch;
+ public:
+    MospfPath(SpfArea *);
+    ~MospfPath();
+    int add_ds(TNode *nh);
+    void add_branch(TNode *V, int ds);
+    friend class OSPF;
+    friend class SpfArea;
+    friend class MospfTree;
+};
+
+/* MOSPF paths through all areas for sources best matching
+ * a given routing table entry. Reused by all groups until
+ * the cache is invalidated.
+ */
+
+class MospfTree : public AVLitem {
+    MospfPath *paths;	// One per area
+ public:
+    MospfTree(INrte *srte);
+    ~MospfTree();
+    friend class OSPF;
+};
@@ -53,6 +53,8 @@ public:
     virtual void update_in_place(LSA *);
     virtual void parse_overlay_lsa(LShdr *hdr);
     virtual void unparse_overlay_lsa();
+    void parse_prefix(Prefixhdr *prefhdr);
+    static void unparse_prefix(overlayPrefixLSA *pref);
     SpfNbr *grace_lsa_parse(byte *, int, int &);
     friend class OSPF;
     friend class INrte;
@@ -70,29 +72,99 @@ class OpqHoldQ : public AVLitem {
     friend class OSPF;
 };
 
+/* A neighbor described in an ABR-LSA. The neighbors of each
+ * ABR-LSA are kept in a contiguous array, rebuilt when the
+ * LSA is parsed. The routing table entry of the neighboring
+ * ABR is cached, so that the overlay Dijkstra reaches the
+ * neighbor's ABR-LSA without a tree lookup. Each entry of
+ * the current array is also linked off the neighbor's entry,
+ * so that the links into an ABR can be found without
+ * scanning every ABR-LSA.
+ */
+
 class AbrLSAItem {
-    ABRhdr nbr;
-    AbrLSAItem *next;
-    AbrLSAItem *prev;
+    ABRhdr nbr;     // Neighbor ID (host order) and metric
+    ABRrte *adv;    // Entry of the neighboring ABR
+    overlayAbrLSA *src; // ABR-LSA describing the neighbor
+    AbrLSAItem *in_next;    // Link in neighbor's incoming links
+    AbrLSAItem **in_pprev;  // Previous link to us, if linked
 public:
-    AbrLSAItem();
-    ~AbrLSAItem();
+    inline AbrLSAItem();
+    inline overlayAbrLSA *target();
+    inline void link_in();
+    inline void unlink_in();
     friend class OSPF;
     friend class opqLSA;
+    friend class overlayAbrLSA;
 };
 
+// Inline functions
+inline AbrLSAItem::AbrLSAItem() : adv(0), src(0), in_next(0), in_pprev(0)
+{
+}
+inline overlayAbrLSA *AbrLSAItem::target()
+{
+    return(adv->abr_lsa);
+}
+inline void AbrLSAItem::link_in()
+{
+    if ((in_next = adv->in_links))
+        in_next->in_pprev = &in_next;
+    in_pprev = &adv->in_links;
+    adv->in_links = this;
+}
+inline void AbrLSAItem::unlink_in()
+{
+    if (!in_pprev)
+        return;
+    if ((*in_pprev = in_next))
+        in_next->in_pprev = in_pprev;
+    in_pprev = 0;
+}
+
 class overlayAbrLSA : public PriQElt, public AVLitem {
     opqLSA *lsa;    // Corresponding opaque-LSA
+    ABRrte *adv;    // Index of the advertising ABR
     uns32 cost;     // Cost to the ABR
     byte overlay_dijk_run:1;    // Overlay Dijkstra run
     byte t_state;   // Current state of this ABR, in the dijkstra calc
-    overlayAbrLSA *t_parent;    // Parent on the SPF Tree
-    overlayAbrLSA *next_abr_hop;    // First ABR hop to this ABR
+    int n_parents;  // Number of equal-cost parents
+    overlayAbrLSA *t_parents[MAXPATH];  // Parents on the SPF Tree
+    int n_nh;       // Number of next ABR hops
+    overlayAbrLSA *next_abr_hops[MAXPATH];  // First ABR hops to this ABR
     int n_nbrs;     // Number of neighbors described
-    AbrLSAItem *nbrs;   // Neighbors described in the LSA
+    int nbr_size;   // Allocated size of nbrs
+    AbrLSAItem *nbrs;   // Neighbors described in the LSA, by Router ID
+    // Incremental overlay calculation
+    bool spt_pending;   // Neighbors changed since the last overlay calculation
+    overlayAbrLSA *pend_next;   // Link in list of pending ABR-LSAs
+    int n_old_nbrs;     // Number of neighbors used by the last calculation
+    int old_size;       // Allocated size of old_nbrs
+    AbrLSAItem *old_nbrs;   // Neighbors used by the last calculation
+    byte spt_mark;      // Affected by an increased/removed tree link?
+    overlayAbrLSA *aff_next;    // Link in list of affected ABRs
+    bool nh_changed;    // Next ABR hops changed when put onto the tree
+    bool touched;       // Cost or parent modified by current calculation
+    overlayAbrLSA *touch_next;  // Link in list of touched ABRs
+    uns32 old_cost;     // Cost before current calculation
+    int n_old_nh;       // Next ABR hops before current calculation
+    overlayAbrLSA *old_nhs[MAXPATH];
+    bool changed;       // Cost or next ABR hop changed by last calculation
+    overlayAbrLSA *chg_next;    // Link in list of changed ABRs
 public:
     overlayAbrLSA(class opqLSA *);
     ~overlayAbrLSA();
+    void unlink_nbrs();
+    void save_nbrs();
+    void set_nbrs(ABRhdr *body, int n);
+    static int nbr_compare(const void *, const void *);
+    bool has_parent(overlayAbrLSA *parent);
+    void add_parent(overlayAbrLSA *parent);
+    void del_parents(uns32 at_cost);
+    bool has_nh(overlayAbrLSA *nh);
+    bool set_nh(overlayAbrLSA *root);
+    void save_path();
+    bool path_changed();
     friend class OSPF;
     friend class opqLSA;
     friend class ABRNbr;
@@ -103,12 +175,20 @@ class overlayPrefixLSA : public AVLitem {
     INrte *rte;         // Associated routing table entry
     Prefixhdr prefix;  // Prefix information
     overlayPrefixLSA *link; // Link together
+    overlayAbrLSA *abr; // ABR-LSA of the advertising ABR
+    overlayPrefixLSA *abr_link; // Link in advertising ABR's list
+    bool stale;         // Its Packed Prefix-LSA is being replaced
+    overlayPrefixLSA *stale_next;   // Link in list of stale prefixes
 public:
     overlayPrefixLSA(class opqLSA *, Prefixhdr *p);
     ~overlayPrefixLSA();
+    static SlabAlloc slab;  // Allocator for overlay prefixes
+    void *operator new(size_t size) { return(slab.alloc(size)); }
+    void operator delete(void *ptr, size_t size) { slab.release(ptr, size); }
     friend class OSPF;
     friend class opqLSA;
     friend class INrte;
+    friend class overlayAbrLSA;
 };
 
 class overlayAsbrLSA : public AVLitem {
@@ -116,12 +196,18 @@ class overlayAsbrLSA : public AVLitem {
     ASBRrte *rte;   // Associated routing table entry
     ASBRhdr asbr;  // Destination ASBR information
     overlayAsbrLSA *link;   // Link together
+    overlayAbrLSA *abr; // ABR-LSA of the advertising ABR
+    overlayAsbrLSA *abr_link;   // Link in advertising ABR's list
 public:
     overlayAsbrLSA(class opqLSA *, ASBRhdr *asbr);
     ~overlayAsbrLSA();
+    static SlabAlloc slab;  // Allocator for overlay ASBRs
+    void *operator new(size_t size) { return(slab.alloc(size)); }
+    void operator delete(void *ptr, size_t size) { slab.release(ptr, size); }
     friend class OSPF;
     friend class opqLSA;
     friend class ASBRrte;
+    friend class overlayAbrLSA;
 };
     
     
\ No newline at end of file
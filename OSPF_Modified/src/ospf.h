@@ -52,14 +52,25 @@ class HitlessRSTTimer : public Timer {
     virtual void action();
 };
 
+// Overlay (ABR-LSA) routing calculation throttling
+
+class OverlayTimer : public Timer {
+  public:
+    virtual void action();
+};
+
 // Global timer queue
-extern PriQ timerq;		// Currently pending timers
+extern TimerWheel timerq;	// Currently pending timers
 
 /* The OSPF base class. This class contains all the data necessary
  * to run a sungle instance of the OSPF protocol.
  */
 
 class OSPF : public ConfigItem {
+    enum {
+	IfcHashSize = 256, // Buckets in interface hash tables
+	NbrHashSize = 256, // Buckets in neighbor hash table
+    };
     // Global configuration data
     const rtid_t myid;	// Our router ID
     bool inter_area_mc; // An inter-area multicast forwarder?
@@ -73,10 +84,16 @@ class OSPF : public ConfigItem {
     int32 refresh_rate;	// Rate to refresh DoNotAge LSAs
     uns32 PPAdjLimit;	// Max # p-p adjacencies to neighbor
     bool random_refresh;// Should we spread out LSA refreshes?
+    uns32 ovl_init_delay;// Overlay calculation delay after quiet (ms)
+    uns32 ovl_hold;	// Initial overlay calculation hold time (ms)
+    uns32 ovl_max_hold;	// Maximum overlay calculation hold time (ms)
     // Dynamic data
     InAddr myaddr;	// Global address: source on unnumbered
     bool wakeup; 	// Timers running?
     SpfIfc *ifcs; 	// List of interfaces
+    SpfIfc *ifc_byaddr[IfcHashSize]; // Real interfaces, by address
+    SpfIfc *ifc_byphy[IfcHashSize]; // Real interfaces, by phyint
+    SpfNbr *nbr_hash[NbrHashSize]; // Neighbors, by lookup key
     int	inter_AS_mc:1;	// Are we an inter-AS multicast forwarder?
     int n_extImports;	// # Imported AS externals
     AVLtree extLSAs;	// AS-external-LSAs
@@ -105,13 +122,15 @@ class OSPF : public ConfigItem {
     HitlessPrepTimer htltim;
     int grace_period;	// Length of grace period (current or next)
     byte restart_reason;// Encoding in lshdr.h
-    TLVbuf tlvbuf;	// Buffer in which grace-LSAs are built
+    TLVbuf tlvbuf;	// Buffer in which grace-LSAs and
+    			// Packed Prefix-LSAs are built
     bool delete_neighbors; // Neighbors being deleted?
     AVLtree phyints;	// Physical interfaces
     AVLtree krtdeletes;	// Deleted, unsynced kernel routing entries
     bool need_remnants; // Yet to get remnants?
     // Flooding queues
     int	n_local_flooded;// AS-external-LSAs originated this tick
+    bool rx_batch;	// Receiving a batch of packets, delay flooding
     ExRtData *ases_pending; // Pending AS-external-LSA originations
     ExRtData *ases_end;	// End of pending AS-external-LSAs
     LocalOrigTimer origtim; // AS-external-LSA origination timer
@@ -130,7 +149,9 @@ class OSPF : public ConfigItem {
     AVLtree ospfd_membership; // Our application's
     AVLtree local_membership; // Of local LAN segments
     AVLtree multicast_cache; // MOSPF Cache entries
+    AVLtree mospf_trees; // MOSPF paths, by source routing table entry
     bool clear_mospf;	// Delete cache on next timer tick?
+    bool mospf_topo_changed; // Area topology changed since last clear?
 
     SpfArea *areas; 	// List of areas
     SpfArea *summary_area;
@@ -145,8 +166,12 @@ class OSPF : public ConfigItem {
     // State flags
     int	full_sched:1,	// true => full calculation scheduled
 	ase_sched:1;	// true => all ases should be reexamined
+    INrte *ases_dirty;	// Entries whose ases should be reexamined
     // Statistics
     uns32 n_dijkstras;
+    uns32 n_ase_full;	// Full external calculations
+    uns32 n_ase_partial; // Calculations over ases_dirty only
+    uns32 n_ase_touched; // Entries recalculated in last pass
     // Logging variables
     int logno;		// Logging event number
     char logbuf[200];   // Logging buffer
@@ -175,14 +200,34 @@ class OSPF : public ConfigItem {
     bool send_all_prefixes; // Advertise all the current prefixes and ASBRs in the overlay
     bool calc_overlay;  // Perform the complete overlay topology calculations
     int asbr_seq;   // Next value for the opaque-ID to be assigned to a ASBR-LSA
-    ABRhdr body_start;  // Placeholder for the origination of our ABR-LSAs
+    ABRhdr *abr_buff;   // Staging area for the body of our ABR-LSA
+    int abr_size;       // Number of entries in abr_buff
     overlayAbrLSA *my_abr_lsa;    // Our own ABR-LSA
     AVLtree ABRNbrs;    // List of all our neighboring ABRs
     AVLtree abrLSAs;    // List of all ABR-LSAs
     AVLtree prefixLSAs; // List of all Prefix-LSAs 
     AVLtree asbrLSAs;   // List of all ASBR-LSAs
     AVLtree ABRtree;    // Tree of all ABRs
+    AVLtree pfx_buckets;    // Our Packed Prefix-LSAs
+    PrefixBucket *pfx_room; // Buckets with space for more prefixes
+    PrefixBucket *pfx_dirty;    // Buckets to be reoriginated
+    int n_pfx_dirty;    // Number of buckets on pfx_dirty
+    ASBRrte *asbrs_pending; // ASBR-LSAs waiting to be originated
+    int n_asbrs_pending;    // Number of entries on asbrs_pending
+    uns32 n_ovl_deferred;   // Times overlay originations hit the rate limit
+    uns32 next_bucket_id;   // Next Opaque ID for a Packed Prefix-LSA
+    overlayPrefixLSA *stale_prefixes;   // Prefixes of Packed Prefix-LSAs being replaced
     uns32 n_overlay_dijkstras;  // Number of Dijkstra's calculations performed over the ABR overlay
+    uns32 n_overlay_incrementals;   // Number of incremental overlay calculations
+    uns32 n_overlay_nh;     // Next ABR hops derived during the overlay calculations
+    bool overlay_full;  // Incremental overlay calculation not possible
+    overlayAbrLSA *overlay_pending; // ABR-LSAs changed since the last overlay calculation
+    overlayAbrLSA *overlay_touched; // ABRs modified by the current overlay calculation
+    overlayAbrLSA *overlay_affected;    // ABRs losing their path in the current calculation
+    overlayAbrLSA *overlay_changed; // ABRs changed by the last overlay calculation
+    OverlayTimer ovltim;    // Delays and throttles the overlay calculations
+    uns32 ovl_wait;     // Current hold time between overlay calculations (ms)
+    SPFtime ovl_last;   // Time of the last overlay calculation
 
     // Monitoring routines
     class MonMsg *get_monbuf(int size);
@@ -202,6 +247,11 @@ class OSPF : public ConfigItem {
     SpfIfc *find_ifc(uns32 addr, int phyint = -1);
     SpfIfc *next_ifc(uns32 addr, int phyint);
     SpfIfc *find_ifc(Pkt *pdesc);
+    bool ifc_accepts(SpfIfc *ip, Pkt *pdesc, InAddr ipsrc, InAddr ipdst);
+    void ifc_hash_add(SpfIfc *ip);
+    void ifc_hash_delete(SpfIfc *ip);
+    void nbr_hash_add(SpfNbr *np);
+    void nbr_hash_delete(SpfNbr *np);
     SpfIfc *find_vl(aid_t transit_id, rtid_t endpt);
     SpfIfc *next_vl(aid_t transit_id, rtid_t endpt);
     SpfIfc *find_nbr_ifc(InAddr nbr_addr);
@@ -240,6 +290,7 @@ class OSPF : public ConfigItem {
     void ParseLSA(LSA *lsap, LShdr *hdr);
     void UnParseLSA(LSA *lsap);
     LShdr *BuildLSA(LSA *lsap, LShdr *hdr=0);
+    LShdr *LSAImage(LSA *lsap);
     void send_updates();
     bool maxage_free(byte lstype);
     void flush_self_orig(AVLtree *tree);
@@ -295,11 +346,14 @@ class OSPF : public ConfigItem {
     void update_area_ranges(INrte *rte);
     void advertise_ranges();
     void do_all_ases();
+    void ase_dirty(INrte *rte);
+    void do_changed_ases();
     void krt_sync();
     
     // MOSPF routines
     INrte *mc_source(InAddr src);
     void add_negative_mcache_entry(InAddr src, INrte *srte, InAddr group);
+    class MospfTree *mospf_tree(INrte *rte);
     // MOSPF cache maintenance
     void mospf_clear_cache();
     void mospf_clear_inter_source(INrte *rte);
@@ -328,16 +382,31 @@ class OSPF : public ConfigItem {
     // Multi-area arbitrary topologies extension
     void orig_abrLSA();
     void orig_prefixLSA(INrte *);
+    void withdraw_prefixLSA(INrte *);
+    void orig_prefix_bucket(PrefixBucket *);
+    int pfx_bucket_capacity();
     void orig_asbrLSA(ASBRrte *);
+    void asbrLSA_schedule(ASBRrte *);
+    bool ovl_orig_pending();
     void advertise_all_prefixes();
     // void parse_delayed_lsas();
 
+    ABRhdr *abr_buffer(int n_entries);
     void overlay_calc();
+    void overlay_sched();
+    void overlay_run();
     void overlay_dijkstra();
-    void set_overlay_nh();
+    void overlay_incremental();
+    void overlay_relax(overlayAbrLSA *, overlayAbrLSA *, uns32, PriQ &);
+    void overlay_touch(overlayAbrLSA *);
+    void overlay_affect(overlayAbrLSA *);
+    void clear_overlay_pending();
+    void clear_overlay_changed();
     void prefix_scan();
+    void changed_prefix_scan();
     void update_path_overlay(RTE *, overlayAbrLSA *, uns32 c);
-    void adv_best_prefix(INrte *);
+    void adv_best_prefix(INrte *, bool resolve_fa = true);
+    void withdraw_stale_prefixes();
     void adv_best_asbr(ASBRrte *);
 
     ABRrte *add_abr(uns32 rtrid);
@@ -368,6 +437,8 @@ class OSPF : public ConfigItem {
     OSPF(uns32 rtid, SPFtime grace);
     ~OSPF();
     void rxpkt(int phyint, InPkt *pkt, int plen);
+    void rxbatch_start();
+    void rxbatch_end();
     int	timeout();
     void tick();
     void monitor(struct MonMsg *msg, byte type, int size, int conn_id);
@@ -378,6 +449,7 @@ class OSPF : public ConfigItem {
     void phy_up(int phyint);
     void phy_down(int phyint);
     void krt_delete_notification(InAddr net, InMask mask);
+    void krt_resync();
     void remnant_notification(InAddr net, InMask mask);
     MPath *ip_lookup(InAddr dest);
     InAddr ip_source(InAddr dest);
@@ -449,12 +521,16 @@ class OSPF : public ConfigItem {
     friend class overlayPrefixLSA;
     friend class overlayAsbrLSA;
     friend class ABRNbr;
+    friend class PrefixBucket;
+    friend class MospfPath;
     friend class HitlessPrepTimer;
     friend class HitlessRSTTimer;
+    friend class OverlayTimer;
     friend void lsa_flush(class LSA *);
     friend void ExRtData::clear_config();
     friend SpfNbr *GetNextAdj();
     friend void INrte::run_external();
+    friend int main(int argc, char *argv[]);
 };
 
 // Declaration of the single OSPF protocol instance
@@ -34,6 +34,7 @@
 #include "tlv.h"
 #include "config.h"
 #include "pat.h"
+#include "slab.h"
 #include "rte.h"
 #include "lsa.h"
 #include "lsalist.h"
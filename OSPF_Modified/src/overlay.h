@@ -12,6 +12,7 @@ class ABRNbr : public AVLitem {
     rtrLSA *rtr;    // Link to corresponding Router-LSA
     SpfArea *area;  // Area in which we are neighbors with the ABR
     bool use_in_lsa;    // This ABRNbr is to be considered when building the ABR-LSA
+    ABRrte *adv;    // Overlay entry of the neighboring ABR
 public:
     ABRNbr(rtrLSA *lsa, SpfArea *a);
     virtual ~ABRNbr();
@@ -24,6 +25,7 @@ public:
     friend class OSPF;
     friend class LSA;
     friend class rtrLSA;
+    friend int main(int argc, char *argv[]);
 };
 
 // Inline functions
@@ -42,4 +44,31 @@ inline rtrLSA *ABRNbr::get_rtrLSA()
 inline SpfArea *ABRNbr::get_area()
 {
     return(area);
-}
\ No newline at end of file
+}
+
+/* A group of our own intra-area prefixes that are advertised
+ * together in a single Packed Prefix-LSA. A prefix stays in the
+ * same bucket for as long as it is advertised, so that a change
+ * to a single prefix only requires the reorigination of its bucket.
+ * Buckets are filled up to the number of prefixes that fit
+ * in a single Link State Update at the OSPF MTU.
+ */
+
+class PrefixBucket : public AVLitem {
+    int n_prefixes;     // Number of prefixes in the bucket
+    int capacity;       // Maximum number of prefixes
+    INrte *members;     // Prefixes, linked through INrte::bucket_link
+    bool dirty;         // Needs to be reoriginated
+    PrefixBucket *dirty_next;   // Link in list of buckets to reoriginate
+    bool has_room;      // On list of buckets with available space
+    PrefixBucket *room_next;    // Link in list of buckets with space
+public:
+    PrefixBucket(uns32 id, int cap);
+    inline lsid_t ls_id();
+    friend class OSPF;
+};
+
+inline lsid_t PrefixBucket::ls_id()
+{
+    return((OPQ_T_MULTI_PREFIXES << 24) | index1());
+}
@@ -20,7 +20,7 @@
 /* Classes representing a Priority queue. This data structure is
  * particular efficient for adding items to a list and then deleting
  * the item with the smallest cost. We use it for the Dijkstra
- * algorithm, and also to implement the timer queue.
+ * algorithm.
  */
 
 /* Representation of an individual element on a
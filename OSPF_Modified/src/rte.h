@@ -65,18 +65,123 @@ enum {
     RT_NONE,	// Deleted, inactive
 };
 
-/* The IP routing table.
+/* One level of the longest-prefix-match index kept alongside
+ * the IP routing table. Each level consumes eight bits of the
+ * address; a prefix is stored (expanded) at the level holding
+ * its last bit, in every slot it covers that does not already
+ * hold a longer prefix. A lookup therefore touches at most
+ * one slot per level.
+ *
+ * The slots are not stored directly, since most are empty
+ * or repeat their neighbor. Instead, as in Poptrie, one
+ * bitmap marks the slots having a child, and another the
+ * slots starting a new run of entries; the child or entry
+ * for a slot is then found by counting the bits set below
+ * it. The arrays are kept with room to spare, so that a
+ * single slot can be changed by shifting their tails; a
+ * node is rebuilt only when a short prefix changes many of
+ * its slots at once.
+ */
+
+class LpmNode {
+  public:
+    enum {
+	Stride = 8,
+	Levels = 32/Stride,
+	Fanout = 1 << Stride,
+	Words = Fanout/32,
+	MaxSlotSet = 16, // Slots changed one at a time
+    };
+  private:
+    uns32 child_map[Words];	// Slots with a child
+    uns32 run_map[Words];	// Slots starting a run
+    uns16 child_base[Words];	// Bits set in preceding words
+    uns16 run_base[Words];
+    uns16 n_children;
+    uns16 child_space;	// Allocated size of children
+    uns16 n_runs;
+    uns16 run_space;
+    LpmNode **children;
+    INrte **runs;		// Entry for each run
+    void set_bases();
+  public:
+    LpmNode();
+    ~LpmNode();
+    inline INrte *rte(int slot);
+    inline LpmNode *child(int slot);
+    void add_child(int slot, LpmNode *node);
+    void set_rte(int slot, INrte *rte);
+    void expand(INrte **rtes, LpmNode **kids);
+    void compress(INrte **rtes, LpmNode **kids);
+    int bytes();
+    friend class INtbl;
+};
+
+/* Count the bits set in a bitmap word, up to and including
+ * the given bit. Done in parallel within the word, since
+ * the machine may have no population count instruction.
+ */
+
+inline int lpm_rank(uns32 word, int bit)
+
+{
+    word &= 0xffffffff >> (31 - bit);
+    word = word - ((word >> 1) & 0x55555555);
+    word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+    word = (word + (word >> 4)) & 0x0f0f0f0f;
+    return((word * 0x01010101) >> 24);
+}
+
+/* Longest prefix ending in the given slot, if any.
+ */
+
+inline INrte *LpmNode::rte(int slot)
+
+{
+    int w = slot >> 5;
+    int i = run_base[w] + lpm_rank(run_map[w], slot & 31);
+    return(i ? runs[i-1] : 0);
+}
+
+/* Next level below the given slot, if any.
+ */
+
+inline LpmNode *LpmNode::child(int slot)
+
+{
+    int w = slot >> 5;
+    if ((child_map[w] & (1 << (slot & 31))) == 0)
+	return(0);
+    return(children[child_base[w] + lpm_rank(child_map[w], slot & 31) - 1]);
+}
+
+/* The IP routing table. The AVL tree holds the entries in
+ * (net, mask) order; the LPM trie is an index over the same
+ * entries used by best_match(). Entries with non-contiguous
+ * masks cannot be placed in the trie, and while any exist
+ * best_match() falls back to searching the AVL tree.
  */
 
 class INtbl {
   protected:
     AVLtree root; 	// Root of AVL tree
+    LpmNode *lpm;	// Root of LPM trie
+    int n_noncontig;	// Entries missing from the trie
+    uns32 n_lpm_nodes;	// Memory used by the trie
+    uns32 lpm_bytes;
+    void lpm_add(INrte *rte);
+    void lpm_free(LpmNode *node);
   public:
-    int next_id;    // Next Opaque ID to be assigned to a Prefix-LSA
-    
+    enum {
+	MatchBatch = 32, // Lookups interleaved by batch best_match
+    };
+    INtbl();
     INrte *add(uns32 net, uns32 mask);
     inline INrte *find(uns32 net, uns32 mask);
     INrte *best_match(uns32 addr);
+    void best_match(uns32 *addrs, INrte **matches, int n);
+    INrte *avl_match(uns32 addr); // Slower, checks best_match
+    void clear();
     friend class INiterator;
     friend class OSPF;
 };
@@ -195,19 +300,25 @@ class INrte : public RTE {
   protected:
     INrte *_prefix;	// Previous less specific match
     uns32 tag;		// Advertised tag
-    int uid;    // Unique ID (used as the Opaque ID)
 
   public:
     overlayPrefixLSA *in_use;   // Prefix being used to advertise this destination
     class summLSA *summs;	// summary-LSAs
     class ASextLSA *ases;	// AS-external-LSAs
     class overlayPrefixLSA *prefixes;   // Prefix-LSAs
+    class PrefixBucket *bucket; // Packed Prefix-LSA we advertise it in
+    INrte *bucket_link;         // Link in bucket
     class ExRtData *exlist;	// Statically configured routes
     class ExRtData *exdata;	// When we're importing information
+    INrte *ase_next;		// Pending external recalculation
     byte range:1,		// Configured area address range?
-	 ase_orig:1;		// Have we originated an AS-external-LSA?
+	 ase_orig:1,		// Have we originated an AS-external-LSA?
+	 ase_pending:1;		// On pending external list?
 
     inline INrte(uns32 xnet, uns32 xmask);
+    static SlabAlloc slab;	// Allocator for INrtes
+    inline void *operator new(size_t size);
+    inline void operator delete(void *ptr, size_t size);
     inline uns32 net();
     inline uns32 mask();
     inline bool matches(InAddr addr);
@@ -229,9 +340,18 @@ class INrte : public RTE {
     friend class INiterator;
     friend class INtbl;
     friend class OSPF;
+    friend int main(int argc, char *argv[]);
 };
 
 // Inline functions
+inline void *INrte::operator new(size_t size)
+{
+    return(slab.alloc(size));
+}
+inline void INrte::operator delete(void *ptr, size_t size)
+{
+    slab.release(ptr, size);
+}
 inline INrte::INrte(uns32 xnet, uns32 xmask) : RTE(xnet, xmask)
 {
     _prefix = 0;
@@ -242,8 +362,12 @@ inline INrte::INrte(uns32 xnet, uns32 xmask) : RTE(xnet, xmask)
     exlist = 0;
     range = false;
     ase_orig = false;
+    ase_next = 0;
+    ase_pending = false;
     prefixes = 0;
     in_use = 0;
+    bucket = 0;
+    bucket_link = 0;
 }
 inline uns32 INrte::net()
 {
@@ -347,12 +471,16 @@ class ASBRrte : public RTE {
     class asbrLSA *summs; // ASBR-summary-LSAs
     class overlayAsbrLSA *asbr_lsas;    // ASBR-LSAs (overlay)
     int uid;    // Unique ID (used as the Opaque ID)
+    ASBRrte *ovl_pend;  // ASBR-LSA origination pending list
+    bool ovl_pending;   // On ASBR-LSA pending list?
+    class ASextLSA *ase_lsas; // AS-external-LSAs it originated
 
     ASBRrte(uns32 rtrid);
     inline uns32 rtrid();
     inline ASBRrte *next();
     void run_calculation();// Run full routing calculations
     void run_inter_area(); // Calculate inter-area routes
+    void sched_externals(); // Recalculate dependent externals
     friend class asbrLSA;
 };
 
@@ -366,11 +494,20 @@ inline ASBRrte *ASBRrte::next()
     return(sll);
 }
 
-/* ABR routing table entries
+/* ABR routing table entries. Also index the overlay LSAs
+ * originated by each ABR, so that only the destinations
+ * advertised by an ABR need to be reexamined when the
+ * cost to that ABR changes.
  */
 
 class ABRrte : public RTE {
     public:
+        class overlayAbrLSA *abr_lsa;   // ABR-LSA (overlay)
+        class overlayPrefixLSA *adv_prefixes;   // Prefix-LSAs advertised
+        class overlayAsbrLSA *adv_asbrs;    // ASBR-LSAs advertised
+        class ABRNbr *sel_nbr;  // Entry used in our ABR-LSA, if neighbor
+        class AbrLSAItem *in_links; // ABR-LSA entries naming this ABR
+
         ABRrte(uns32 rtrid);
         inline uns32 rtrid();
         friend class OSPF;
@@ -442,14 +579,19 @@ class FWDtbl {
 class FWDrte : public RTE {
     SpfIfc *ifp;	// On this interface
     INrte *match;	// Best matching routing table entry
+    class ASextLSA *ase_lsas; // AS-external-LSAs using it
+    int n_cfg;		// Configured routes using it
   public:
     inline FWDrte(uns32 addr);
     inline InAddr address();
     void resolve();
+    void resolve(INrte *best);
+    void sched_externals();
     friend class OSPF;
     friend class INrte;
     friend class ExRtData;
     friend class FWDtbl;
+    friend class ASextLSA;
 };
 
 // Inline functions
@@ -457,6 +599,8 @@ inline FWDrte::FWDrte(uns32 addr) : RTE(addr, 0)
 {
     ifp = 0;
     match = 0;
+    ase_lsas = 0;
+    n_cfg = 0;
 }
 inline InAddr FWDrte::address()
 {
@@ -0,0 +1,58 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *   
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *   
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Definitions for the slab allocators, used for the objects
+ * that are allocated and freed in large numbers, such as LSAs
+ * and routing table entries. This generalizes the free list
+ * kept for LsaListElements to objects of varying size.
+ *
+ * Requests are rounded up to a multiple of Granularity bytes,
+ * and each such size class has its own free list. Free lists
+ * are refilled ChunkSize bytes at a time. Memory is never
+ * returned to the system, but is reused by later allocations
+ * of the same size class. Requests larger than MaxSlab go
+ * directly to the system allocator.
+ *
+ * Each hot object type has its own SlabAlloc, so that
+ * statistics are kept per type.
+ */
+
+class SlabAlloc {
+    enum {
+	Granularity = 16, // Size classes are multiples of this
+	MaxSlab = 1024,	// Largest size served from the slabs
+	ChunkSize = 16384, // Bytes obtained from the system at once
+	NClasses = MaxSlab/Granularity,
+    };
+    struct SlabFree {
+	SlabFree *next;
+    };
+    SlabFree *freelist[NClasses]; // Free objects, by size class
+public:
+    uns32 n_inuse;	// Objects currently allocated
+    uns32 bytes_inuse;	// Bytes currently allocated
+    uns32 bytes_reserved;// Bytes obtained from the system
+    static uns32 total_reserved;// Over all allocators
+
+    SlabAlloc();
+    void *alloc(size_t size);
+    void release(void *ptr, size_t size);
+    byte *get_bytes(int len);
+    void free_bytes(byte *);
+};
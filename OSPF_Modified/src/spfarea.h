@@ -100,6 +100,7 @@ class SpfArea : public ConfigItem {
     void asbr_orig(class ASBRrte *rte, int forced=0);
     bool needs_indication();
     void grp_orig(InAddr group, int forced=0);
+    bool has_members(byte lstype, lsid_t lsid, rtid_t adv, InAddr group);
     void delete_lsdb();
     void a_flush_donotage();
     void reinitialize();
@@ -113,8 +114,8 @@ class SpfArea : public ConfigItem {
     void adj_change(SpfNbr *, int n_ostate);
 
     // MOSPF routines
-    void mospf_path_calc(InAddr, INrte *, int &, uns32 &, LsaList *);
-    void mospf_dijkstra(InAddr, PriQ &cand, bool, LsaList *downstream_nodes);
+    void mospf_path_calc(INrte *, class MospfPath *);
+    void mospf_dijkstra(PriQ &cand, bool, class MospfPath *);
     void mospf_possibly_add(PriQ &, TNode *, uns32, TNode *, int il_type, int);
     INrte *find_best_summlsa(INrte *);
     int mospf_init_intra_area(PriQ &cand, INrte *, uns32, int);
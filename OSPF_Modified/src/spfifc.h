@@ -135,6 +135,8 @@ class SpfIfc : public ConfigItem {
 
     // Dynamic parameters
     SpfIfc *next; 	// Linked list of interfaces
+    SpfIfc *addr_hnext; // Hash chain, by interface address
+    SpfIfc *phy_hnext;	// Hash chain, by physical interface
     SpfIfc  *anext; 	// List by area
     Pkt	if_update;	// Pending update
     Pkt	if_dack;	// Pending delayed acks
@@ -220,12 +222,13 @@ class SpfIfc : public ConfigItem {
     rtid_t *vl_endpt();
     void AddTypesToList(byte lstype, LsaList *lp);
     void delete_lsdb();
+    class SpfNbr *find_nbr(InAddr, rtid_t);
 
     // Virtual functions
     virtual void clear_config();
     virtual void if_send(Pkt *, InAddr);
     virtual void nbr_send(Pkt *, SpfNbr *); // send OSPF packet to neighbor
-    virtual class SpfNbr *find_nbr(InAddr, rtid_t);
+    virtual uns32 nbr_key(InAddr, rtid_t);
     virtual void set_id_or_addr(SpfNbr *, rtid_t, InAddr);
     virtual RtrLink *rl_insert(RTRhdr *, RtrLink *) = 0;
     virtual int rl_size();
@@ -325,7 +328,7 @@ class PPIfc : public SpfIfc {
   public:
     inline PPIfc(InAddr addr, int phyint);
     virtual void ifa_start();
-    virtual class SpfNbr *find_nbr(InAddr, rtid_t);
+    virtual uns32 nbr_key(InAddr, rtid_t);
     virtual void set_id_or_addr(SpfNbr *, rtid_t, InAddr);
     virtual void if_send(Pkt *, InAddr);
     virtual void nbr_send(Pkt *, SpfNbr *);
@@ -183,6 +183,8 @@ class SpfNbr {
 
 protected:
     SpfNbr *next; 	// List, per OSPF interface
+    uns32 n_hkey;	// Lookup key, address or Router ID
+    SpfNbr *n_hnext;	// Global hash chain
     SpfIfc *n_ifp; 	// Associated OSPF interface
 
 public:
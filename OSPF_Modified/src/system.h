@@ -24,6 +24,9 @@
 
 class OspfSysCalls {
 public:
+    uns32 n_xmt_pkts;	// Packets handed to the kernel
+    uns32 n_xmt_calls;	// System calls used to send them
+
     InPkt *getpkt(uns16 len);
     void freepkt(InPkt *pkt);
     OspfSysCalls();
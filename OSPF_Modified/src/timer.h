@@ -20,20 +20,72 @@
 /* Declaration of OSPF timer classes.
  */
 
+/* Linkage for the doubly linked, circular lists that make
+ * up the timer wheel. The list heads (the wheel slots) are
+ * bare TimerLinks; the elements are Timers.
+ */
+
+class TimerLink {
+protected:
+    TimerLink *tl_next;
+    TimerLink *tl_prev;
+public:
+    TimerLink() {
+	tl_next = tl_prev = this;
+    }
+    inline bool empty();
+    inline void unlink();
+    inline void append(TimerLink *);
+    inline void splice(TimerLink *);
+    friend class TimerWheel;
+};
+
+// Inline functions
+inline bool TimerLink::empty()
+{
+    return(tl_next == this);
+}
+inline void TimerLink::unlink()
+{
+    tl_prev->tl_next = tl_next;
+    tl_next->tl_prev = tl_prev;
+    tl_next = tl_prev = this;
+}
+inline void TimerLink::append(TimerLink *elt)
+{
+    elt->tl_prev = tl_prev;
+    elt->tl_next = this;
+    tl_prev->tl_next = elt;
+    tl_prev = elt;
+}
+// Move all elements to the end of another list
+inline void TimerLink::splice(TimerLink *list)
+{
+    if (empty())
+	return;
+    tl_next->tl_prev = list->tl_prev;
+    tl_prev->tl_next = list;
+    list->tl_prev->tl_next = tl_next;
+    list->tl_prev = tl_prev;
+    tl_next = tl_prev = this;
+}
+
 /* Implementation of a timer
  * Base class implements a single shot timer.
  * Derived class implements an interval timer
  */
 
-class Timer : public PriQElt {
+class Timer : public TimerLink {
 protected:
     int	active:1;
     uns32 period;		// Period in milliseconds
+    uns32 due;			// Firing time, msec since start
 public:
     enum { SECOND = 1000};
     Timer() {
 	active=false;
 	period = 0;
+	due = 0;
     }
 
     static int random_period(int period);
@@ -46,6 +98,7 @@ public:
     virtual void fire();
     virtual void action() = 0;
     virtual ~Timer();
+    friend class TimerWheel;
 };
 
 // Inline functions
@@ -87,3 +140,42 @@ void	time_add(SPFtime &a, int milliseconds, SPFtime *result);
 bool	time_equal(SPFtime &a, SPFtime &b);
 int	time_diff(SPFtime &a, SPFtime &b);
 
+
+// Elapsed time in milliseconds, as used by the timer wheel
+inline uns32 time_msec(SPFtime &a)
+{
+    return(a.sec*Timer::SECOND + a.msec);
+}
+
+/* The queue of pending timers, organized as a hierarchical
+ * timing wheel so that starting, stopping and restarting a
+ * timer are constant-time operations. The first level has
+ * one slot per millisecond for the next 256 milliseconds;
+ * each higher level has 64 slots, each covering a whole
+ * rotation of the level below. When the first level wraps,
+ * the next slot of the level above is cascaded down into it.
+ * Timers that are already due wait on the expired list.
+ */
+
+class TimerWheel {
+    enum {
+	L0_BITS = 8,
+	LN_BITS = 6,
+	L0_SIZE = 1 << L0_BITS,
+	LN_SIZE = 1 << LN_BITS,
+	N_LEVELS = 4,	// Levels above the first
+    };
+    TimerLink l0[L0_SIZE];
+    TimerLink ln[N_LEVELS][LN_SIZE];
+    TimerLink expired;	// Due, waiting to fire
+    uns32 clock;	// Next millisecond to process
+    int count;		// Number of queued timers
+    void queue(Timer *);
+    void cascade();
+public:
+    TimerWheel();
+    void add(Timer *);
+    void remove(Timer *);
+    void run(uns32 now);
+    int timeout(uns32 now);
+};